@@ -0,0 +1,295 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "compressed_id_vector.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr size_t WORD_BITS = 64;
+
+    constexpr uint64_t width_mask(unsigned width) {
+        return width == WORD_BITS ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+    }
+
+    // Extracts delta number i of a block packed with the given width
+    inline uint64_t unpack_one(const uint64_t *words, unsigned width, size_t i) {
+        size_t bit = i * width;
+        size_t word = bit / WORD_BITS;
+        size_t shift = bit % WORD_BITS;
+
+        uint64_t value = words[word] >> shift;
+        if (shift + width > WORD_BITS) {
+            value |= words[word + 1] << (WORD_BITS - shift);
+        }
+
+        return value & width_mask(width);
+    }
+
+    // Unpacks all deltas of a block of a fixed width; with width known at compile time
+    // the shifts are constants and the loop unrolls and vectorizes
+    template<unsigned WIDTH>
+    void unpack_deltas(const uint64_t *words, uint64_t *out) {
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 128
+#endif
+        for (size_t i = 0; i < compressed_id_vector::BLOCK_SIZE; ++i) {
+            out[i] = unpack_one(words, WIDTH, i);
+        }
+    }
+
+    using unpack_fn = void (*)(const uint64_t *, uint64_t *);
+
+    template<size_t... WIDTHS>
+    constexpr auto make_unpack_table(std::index_sequence<WIDTHS...>) {
+        return std::array<unpack_fn, sizeof...(WIDTHS)>{&unpack_deltas<static_cast<unsigned>(WIDTHS) + 1>...};
+    }
+
+    // unpack_table[width - 1] unpacks a block of that width
+    constexpr auto unpack_table = make_unpack_table(std::make_index_sequence<WORD_BITS>{});
+
+    // Unpacks all deltas first (independent iterations), then turns them into values with a prefix sum
+    void unpack_block(const uint64_t *words, unsigned width, uint64_t first, uint64_t *out) {
+        constexpr size_t BLOCK_SIZE = compressed_id_vector::BLOCK_SIZE;
+
+        if (width == 0) {
+            std::fill_n(out, BLOCK_SIZE, first);
+            return;
+        }
+
+        unpack_table[width - 1](words, out);
+
+        out[0] = first;
+        for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+            out[i] += out[i - 1];
+        }
+    }
+}
+
+compressed_id_vector::compressed_id_vector(const my_vector<uint64_t> &sorted) {
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        push_back(sorted[i]);
+    }
+}
+
+void compressed_id_vector::pack_tail() {
+    uint64_t any_bits = 0;
+    for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+        any_bits |= tail_m[i] - tail_m[i - 1];
+    }
+    auto width = static_cast<unsigned>(std::bit_width(any_bits));
+
+    // BLOCK_SIZE deltas of width bits take exactly BLOCK_SIZE * width / 64 words
+    size_t word_offset = words_m.size();
+    words_m.resize(word_offset + BLOCK_SIZE * width / WORD_BITS, 0);
+
+    if (width != 0) {
+        uint64_t *words = &words_m[word_offset];
+        for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+            uint64_t delta = tail_m[i] - tail_m[i - 1];
+            size_t bit = i * width;
+            size_t word = bit / WORD_BITS;
+            size_t shift = bit % WORD_BITS;
+
+            words[word] |= delta << shift;
+            if (shift + width > WORD_BITS) {
+                words[word + 1] |= delta >> (WORD_BITS - shift);
+            }
+        }
+    }
+
+    blocks_m.push_back(block_info{tail_m[0], tail_m[BLOCK_SIZE - 1], word_offset, static_cast<uint8_t>(width)});
+    tail_m.clear();
+}
+
+const uint64_t *compressed_id_vector::block_words(const block_info &info) const {
+    return info.bit_width == 0 ? nullptr : &words_m[info.word_offset];
+}
+
+void compressed_id_vector::push_back(uint64_t value) {
+    if (size_m != 0 && value <= back()) {
+        throw std::invalid_argument("compressed_id_vector values must be strictly increasing");
+    }
+
+    tail_m.push_back(value);
+    ++size_m;
+
+    if (tail_m.size() == BLOCK_SIZE) {
+        pack_tail();
+    }
+}
+
+size_t compressed_id_vector::size() const {
+    return size_m;
+}
+
+bool compressed_id_vector::is_empty() const {
+    return size_m == 0;
+}
+
+uint64_t compressed_id_vector::operator[](size_t index) const {
+    size_t block = index / BLOCK_SIZE;
+    size_t offset = index % BLOCK_SIZE;
+
+    if (block == blocks_m.size()) {
+        return tail_m[offset];
+    }
+
+    const block_info &info = blocks_m[block];
+    const uint64_t *words = block_words(info);
+    uint64_t value = info.first;
+    for (size_t i = 1; i <= offset && info.bit_width != 0; ++i) {
+        value += unpack_one(words, info.bit_width, i);
+    }
+
+    return value;
+}
+
+uint64_t compressed_id_vector::at(size_t index) const {
+    if (index >= size_m) {
+        throw std::out_of_range("index out of range");
+    }
+
+    return (*this)[index];
+}
+
+uint64_t compressed_id_vector::back() const {
+    return tail_m.is_empty() ? blocks_m.back().last : tail_m.back();
+}
+
+size_t compressed_id_vector::lower_bound(uint64_t value) const {
+    size_t blocks = block_count();
+
+    // First block whose last value is not less than value
+    size_t low = 0;
+    size_t high = blocks;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (block_back(mid) < value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == blocks) {
+        return size_m;
+    }
+
+    uint64_t buffer[BLOCK_SIZE];
+    size_t count = decode_block(low, buffer);
+
+    return low * BLOCK_SIZE + static_cast<size_t>(std::lower_bound(buffer, buffer + count, value) - buffer);
+}
+
+bool compressed_id_vector::contains(uint64_t value) const {
+    size_t index = lower_bound(value);
+
+    return index != size_m && (*this)[index] == value;
+}
+
+size_t compressed_id_vector::block_count() const {
+    return blocks_m.size() + (tail_m.is_empty() ? 0 : 1);
+}
+
+uint64_t compressed_id_vector::block_front(size_t block) const {
+    return block == blocks_m.size() ? tail_m.front() : blocks_m[block].first;
+}
+
+uint64_t compressed_id_vector::block_back(size_t block) const {
+    return block == blocks_m.size() ? tail_m.back() : blocks_m[block].last;
+}
+
+size_t compressed_id_vector::decode_block(size_t block, uint64_t *out) const {
+    if (block == blocks_m.size()) {
+        std::copy_n(tail_m.cbegin(), tail_m.size(), out);
+        return tail_m.size();
+    }
+
+    const block_info &info = blocks_m[block];
+    unpack_block(block_words(info), info.bit_width, info.first, out);
+
+    return BLOCK_SIZE;
+}
+
+my_vector<uint64_t> compressed_id_vector::decode() const {
+    my_vector<uint64_t> values;
+    values.reserve(size_m);
+
+    uint64_t buffer[BLOCK_SIZE];
+    for (size_t block = 0; block < block_count(); ++block) {
+        size_t count = decode_block(block, buffer);
+        values.insert(values.end(), buffer, buffer + count);
+    }
+
+    return values;
+}
+
+size_t compressed_id_vector::memory_footprint() const {
+    return sizeof(*this) + blocks_m.capacity() * sizeof(block_info) +
+           (words_m.capacity() + tail_m.capacity()) * sizeof(uint64_t);
+}
+
+my_vector<uint64_t> intersect(const compressed_id_vector &lhs, const compressed_id_vector &rhs) {
+    constexpr size_t BLOCK_SIZE = compressed_id_vector::BLOCK_SIZE;
+
+    my_vector<uint64_t> result;
+    uint64_t lhs_buffer[BLOCK_SIZE];
+    uint64_t rhs_buffer[BLOCK_SIZE];
+    size_t lhs_decoded = SIZE_MAX;
+    size_t rhs_decoded = SIZE_MAX;
+    size_t lhs_count = 0;
+    size_t rhs_count = 0;
+
+    size_t lhs_block = 0;
+    size_t rhs_block = 0;
+    while (lhs_block < lhs.block_count() && rhs_block < rhs.block_count()) {
+        if (lhs.block_back(lhs_block) < rhs.block_front(rhs_block)) {
+            ++lhs_block;
+            continue;
+        }
+        if (rhs.block_back(rhs_block) < lhs.block_front(lhs_block)) {
+            ++rhs_block;
+            continue;
+        }
+
+        if (lhs_decoded != lhs_block) {
+            lhs_count = lhs.decode_block(lhs_block, lhs_buffer);
+            lhs_decoded = lhs_block;
+        }
+        if (rhs_decoded != rhs_block) {
+            rhs_count = rhs.decode_block(rhs_block, rhs_buffer);
+            rhs_decoded = rhs_block;
+        }
+
+        // Merge the overlapping parts, then advance only the block that ends first:
+        // the other one may still overlap the next block of the opposite list
+        uint64_t upper = std::min(lhs_buffer[lhs_count - 1], rhs_buffer[rhs_count - 1]);
+        const uint64_t *l = std::lower_bound(lhs_buffer, lhs_buffer + lhs_count, rhs_buffer[0]);
+        const uint64_t *r = std::lower_bound(rhs_buffer, rhs_buffer + rhs_count, lhs_buffer[0]);
+        const uint64_t *l_end = std::upper_bound(lhs_buffer, lhs_buffer + lhs_count, upper);
+        const uint64_t *r_end = std::upper_bound(rhs_buffer, rhs_buffer + rhs_count, upper);
+        while (l != l_end && r != r_end) {
+            if (*l < *r) {
+                ++l;
+            } else if (*r < *l) {
+                ++r;
+            } else {
+                result.push_back(*l);
+                ++l;
+                ++r;
+            }
+        }
+
+        if (lhs_buffer[lhs_count - 1] <= rhs_buffer[rhs_count - 1]) {
+            ++lhs_block;
+        } else {
+            ++rhs_block;
+        }
+    }
+
+    return result;
+}
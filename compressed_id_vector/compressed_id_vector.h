@@ -0,0 +1,97 @@
+#ifndef COMPRESSED_ID_VECTOR_H
+#define COMPRESSED_ID_VECTOR_H
+#include <cstddef>
+#include <cstdint>
+#include "my_vector.h"
+
+// Strictly increasing uint64_t list (a sorted ID set) stored as delta-encoded, bit-packed blocks of BLOCK_SIZE values.
+// Every full block keeps its first and last value and packs its deltas with the smallest bit width
+// that fits them; the last, partial block stays uncompressed until it fills up.
+// Random access skips to the block in O(1) and sums at most BLOCK_SIZE deltas;
+// lower_bound() and intersect() skip whole blocks by their first/last values without decoding them.
+class compressed_id_vector {
+public:
+    static constexpr size_t BLOCK_SIZE = 128;
+
+private:
+    struct block_info {
+        uint64_t first;
+        uint64_t last;
+        uint64_t word_offset;
+        uint8_t bit_width;
+    };
+
+    my_vector<block_info> blocks_m;
+    my_vector<uint64_t> words_m;
+    my_vector<uint64_t> tail_m;
+    size_t size_m = 0;
+
+    // Packs tail_m into a new block and empties it
+    void pack_tail();
+
+    // Packed deltas of a full block, nullptr for a block of width 0
+    [[nodiscard]] const uint64_t *block_words(const block_info &info) const;
+
+public:
+    compressed_id_vector() = default;
+
+    // Constructor from a sorted my_vector, throws std::invalid_argument if it is not strictly increasing
+    explicit compressed_id_vector(const my_vector<uint64_t> &sorted);
+
+    // push_back() - value must be greater than back()
+    void push_back(uint64_t value);
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool is_empty() const;
+
+    uint64_t operator[](size_t index) const;
+
+    // Method at() that throws exceptions
+    [[nodiscard]] uint64_t at(size_t index) const;
+
+    [[nodiscard]] uint64_t back() const;
+
+    // Index of the first value not less than value, size() if there is none
+    [[nodiscard]] size_t lower_bound(uint64_t value) const;
+
+    [[nodiscard]] bool contains(uint64_t value) const;
+
+    // Blocks: all full blocks followed by the partial one, if any
+    [[nodiscard]] size_t block_count() const;
+
+    [[nodiscard]] uint64_t block_front(size_t block) const;
+
+    [[nodiscard]] uint64_t block_back(size_t block) const;
+
+    // Decodes one block into out (room for BLOCK_SIZE values), returns the number of values written
+    size_t decode_block(size_t block, uint64_t *out) const;
+
+    // Calls f(value) for every value in order, decoding a block at a time
+    template<class F>
+    void for_each(F f) const;
+
+    // Decodes everything into a plain my_vector
+    [[nodiscard]] my_vector<uint64_t> decode() const;
+
+    // Bytes held by the container, see my_vector::memory_footprint()
+    [[nodiscard]] size_t memory_footprint() const;
+};
+
+// Sorted intersection of two lists; block pairs whose value ranges do not overlap are skipped undecoded
+my_vector<uint64_t> intersect(const compressed_id_vector &lhs, const compressed_id_vector &rhs);
+
+
+template<class F>
+void compressed_id_vector::for_each(F f) const {
+    uint64_t buffer[BLOCK_SIZE];
+
+    for (size_t block = 0; block < block_count(); ++block) {
+        size_t count = decode_block(block, buffer);
+        for (size_t i = 0; i < count; ++i) {
+            f(buffer[i]);
+        }
+    }
+}
+
+#endif //COMPRESSED_ID_VECTOR_H
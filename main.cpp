@@ -4,8 +4,19 @@
 #include <iostream>
 #include <cassert>
 #include "my_vector.h"
+#include "numeric_loader.h"
+#include "slot_map.h"
+#include "compressed_id_vector.h"
 #include <string>
 #include <vector>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 
 // ALL TESTS ARE GGENERATED BY CHATGPT!!!
 
@@ -91,6 +102,13 @@ void test_insert_erase() {
 
     v.erase(v.begin(), v.begin() + 2);
     assert(v[0] == 99);
+
+    my_vector<std::string> words(from_range, std::vector<std::string>{"a", "d"});
+    std::vector<std::string> middle = {"b", "c"};
+    words.insert(words.begin() + 1, middle.begin(), middle.end());
+    assert(words.size() == 4);
+    assert(words[1] == "b");
+    assert(words[3] == "d");
 }
 
 void test_iterators() {
@@ -107,6 +125,429 @@ void test_iterators() {
     assert(*r_it == 20);
 }
 
+void test_memory_reclaim() {
+    my_vector<int> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    assert(v.capacity() >= 100);
+
+    v.erase(v.begin() + 10, v.end());
+    v.shrink_to_fit();
+    assert(v.capacity() == 10);
+    assert(v[9] == 9);
+    assert(v.memory_footprint() == sizeof(v) + 10 * sizeof(int));
+
+    v.clear();
+    assert(v.is_empty());
+    assert(v.capacity() == 10);
+
+    v.clear_and_release();
+    assert(v.capacity() == 0);
+    v.push_back(42);
+    assert(v.back() == 42);
+
+    my_vector<int> w;
+    w.set_shrink_threshold(0.25);
+    for (int i = 0; i < 1000; ++i) {
+        w.push_back(i);
+    }
+    [[maybe_unused]] size_t peak = w.capacity();
+    while (w.size() > 10) {
+        w.pop_back();
+    }
+    assert(w.capacity() < peak);
+    assert(w.capacity() >= w.size());
+    assert(w.back() == 9);
+
+    // At the smallest auto-shrink capacity popping to empty keeps the same buffer
+    my_vector<int> small;
+    small.set_shrink_threshold(0.4);
+    small.push_back(1);
+    [[maybe_unused]] auto small_begin = small.begin();
+    for (int i = 0; i < 5; ++i) {
+        small.pop_back();
+        small.push_back(i);
+    }
+    small.pop_back();
+    assert(small.is_empty());
+    assert(small.begin() == small_begin);
+
+    try {
+        w.set_shrink_threshold(0.75);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+        assert(true);
+    }
+}
+
+void test_range_construction() {
+    std::istringstream in("1 2 3 4 5");
+    my_vector<int> from_stream(std::istream_iterator<int>(in), std::istream_iterator<int>{});
+    assert(from_stream.size() == 5);
+    assert(from_stream[4] == 5);
+
+    std::list<std::string> words = {"a", "b", "c"};
+    my_vector<std::string> from_list(words.begin(), words.end());
+    assert(from_list.size() == 3);
+    assert(from_list.capacity() == 3);
+    assert(from_list[2] == "c");
+
+    std::vector<int> src = {7, 8, 9};
+    my_vector<int> from_vector(src.begin(), src.end());
+    assert(from_vector.size() == 3);
+    assert(from_vector[0] == 7);
+
+    static_assert(std::contiguous_iterator<my_vector<int>::iterator>);
+    my_vector<int> from_my_vector(from_vector.begin(), from_vector.end());
+    assert(from_my_vector == from_vector);
+
+    my_vector<int> evens(from_range, std::views::iota(0, 10) | std::views::filter([](int x) { return x % 2 == 0; }));
+    assert(evens.size() == 5);
+    assert(evens[4] == 8);
+    static_assert(std::is_constructible_v<my_vector<double>, from_range_t, std::vector<int> &>);
+    static_assert(!std::is_constructible_v<my_vector<int>, from_range_t, std::vector<std::string> &>);
+
+    my_vector<int> filled(5, 3);
+    assert(filled.size() == 5);
+    assert(filled[4] == 3);
+
+    std::istringstream more("10 20");
+    filled.assign(std::istream_iterator<int>(more), std::istream_iterator<int>{});
+    assert(filled.size() == 2);
+    assert(filled[1] == 20);
+
+    // A constructor that runs out of budget halfway frees what it has already allocated
+    std::ostringstream many;
+    for (int i = 0; i < 10000; ++i) {
+        many << i << ' ';
+    }
+    std::istringstream many_in(many.str());
+    size_t live_before = memory_budget::global_live_bytes();
+    memory_budget::set_global_limit(live_before + 4096);
+    [[maybe_unused]] bool budget_exceeded = false;
+    try {
+        my_vector<int> too_many(std::istream_iterator<int>(many_in), std::istream_iterator<int>{});
+    } catch (const memory_budget_exceeded &) {
+        budget_exceeded = true;
+    }
+    memory_budget::set_global_limit(memory_budget::UNLIMITED);
+    assert(budget_exceeded);
+    assert(memory_budget::global_live_bytes() == live_before);
+}
+
+void test_const_access() {
+    const my_vector<int> v = {1, 2, 3};
+    static_assert(std::is_same_v<decltype(v[0]), const int &>);
+    assert(v[2] == 3);
+
+    const my_vector<int> w = {1, 2, 4};
+    assert(v < w);
+    assert(v != w);
+
+    try {
+        v.at(3);
+        assert(false);
+    } catch (const std::out_of_range &) {
+        assert(true);
+    }
+}
+
+void test_bulk_fill_copy() {
+    for (size_t n: {0, 1, 7, 31, 33, 100, 1001}) {
+        my_vector<int> v(n, -3);
+        assert(v.size() == n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(v[i] == -3);
+        }
+
+        my_vector<int> copy(v);
+        assert(copy == v);
+    }
+
+    my_vector<char> chars;
+    chars.assign(45, 'x');
+    assert(chars.size() == 45);
+    assert(chars[44] == 'x');
+
+    my_vector<double> doubles = {1.5};
+    doubles.resize(77, 2.5);
+    assert(doubles[0] == 1.5);
+    assert(doubles[76] == 2.5);
+
+    // Large enough to take the streaming-store path
+    my_vector<int64_t> big(3 * 1024 * 1024 + 3, 0x0102030405060708);
+    assert(big[0] == 0x0102030405060708);
+    assert(big[big.size() - 1] == 0x0102030405060708);
+    my_vector<int64_t> big_copy;
+    big_copy = big;
+    assert(big_copy == big);
+
+    my_vector<std::string> strings(3, "abc");
+    my_vector<std::string> strings_copy(strings);
+    assert(strings_copy[2] == "abc");
+}
+
+void test_numeric_loader() {
+    my_vector<double> doubles = parse_numeric_text<double>("1.5,2\n-3e2, 4\n");
+    assert(doubles.size() == 4);
+    assert(doubles[2] == -300.0);
+
+    std::string text;
+    for (int i = 0; i < 10000; ++i) {
+        text += std::to_string(i) + (i % 10 == 9 ? "\n" : ",");
+    }
+    my_vector<int64_t> ints = parse_numeric_text<int64_t>(text, 4);
+    assert(ints.size() == 10000);
+    assert(ints.capacity() == 10000);
+    for (int64_t i = 0; i < 10000; ++i) {
+        assert(ints[i] == i);
+    }
+
+    try {
+        parse_numeric_text<int64_t>("1,2\n3,x4\n5", 3);
+        assert(false);
+    } catch (const numeric_parse_error &e) {
+        assert(e.line() == 2);
+        assert(e.column() == 3);
+    }
+
+    // Allocation failures inside the worker threads reach the caller
+    memory_budget::set_global_limit(memory_budget::global_live_bytes() + 4096);
+    [[maybe_unused]] bool budget_exceeded = false;
+    try {
+        parse_numeric_text<int64_t>(text, 4);
+    } catch (const memory_budget_exceeded &) {
+        budget_exceeded = true;
+    }
+    memory_budget::set_global_limit(memory_budget::UNLIMITED);
+    assert(budget_exceeded);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "my_vector_loader_test.csv";
+    {
+        std::ofstream file(path);
+        file << "10,20\n30\n";
+    }
+    my_vector<int64_t> from_file = load_numeric_file<int64_t>(path.string());
+    std::filesystem::remove(path);
+    assert(from_file.size() == 3);
+    assert(from_file[2] == 30);
+}
+
+int hook_calls = 0;
+
+bool allow_first_allocation_hook(size_t, size_t requested_bytes) {
+    if (hook_calls++ != 0) {
+        return false;
+    }
+    memory_budget::set_global_limit(memory_budget::global_live_bytes() + requested_bytes);
+    return true;
+}
+
+void test_slot_map() {
+    slot_map<std::string> entities;
+    auto a = entities.insert("a");
+    [[maybe_unused]] auto b = entities.insert("b");
+    [[maybe_unused]] auto c = entities.emplace(3, 'c');
+    assert(entities.size() == 3);
+    assert(entities.at(c) == "ccc");
+
+    [[maybe_unused]] bool erased = entities.erase(a);
+    assert(erased);
+    assert(!entities.contains(a));
+    assert(entities.find(a) == nullptr);
+    erased = entities.erase(a);
+    assert(!erased);
+    assert(entities.at(b) == "b");
+    assert(entities.at(c) == "ccc");
+
+    [[maybe_unused]] auto d = entities.insert("d");
+    assert(d.index == a.index);
+    assert(!(d == a));
+    assert(!entities.contains(a));
+    assert(*entities.find(d) == "d");
+
+    size_t total = 0;
+    for (auto &value: entities) {
+        total += value.size();
+    }
+    assert(total == 5);
+
+    try {
+        entities.at(a);
+        assert(false);
+    } catch (const std::out_of_range &) {
+        assert(true);
+    }
+
+    entities.clear();
+    assert(entities.is_empty());
+    assert(!entities.contains(b));
+
+    // A failed insert leaves no value without a slot behind: the hook lets the value storage grow,
+    // then refuses the slot table growth
+    slot_map<int> ids;
+    slot_map<int>::handle last{};
+    for (int i = 0; i < 4; ++i) {
+        last = ids.insert(i);
+    }
+    memory_budget::set_global_limit(memory_budget::global_live_bytes());
+    memory_budget::set_exceeded_hook(allow_first_allocation_hook);
+    [[maybe_unused]] bool insert_failed = false;
+    try {
+        ids.insert(4);
+    } catch (const memory_budget_exceeded &) {
+        insert_failed = true;
+    }
+    memory_budget::set_exceeded_hook(nullptr);
+    memory_budget::set_global_limit(memory_budget::UNLIMITED);
+    assert(insert_failed);
+    assert(ids.size() == 4);
+    erased = ids.erase(last);
+    assert(erased);
+    assert(ids.size() == 3);
+}
+
+void test_compressed_id_vector() {
+    my_vector<uint64_t> evens;
+    my_vector<uint64_t> threes;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        evens.push_back(1000000 + 2 * i);
+        threes.push_back(1000000 + 3 * i + (i > 9000 ? 1ull << 40 : 0));
+    }
+
+    compressed_id_vector a(evens);
+    assert(a.size() == evens.size());
+    for (size_t i = 0; i < evens.size(); i += 37) {
+        assert(a[i] == evens[i]);
+    }
+    assert(a.at(9999) == evens[9999]);
+    assert(a.decode() == evens);
+    assert(a.memory_footprint() * 4 < evens.size() * sizeof(uint64_t));
+
+    assert(a.lower_bound(0) == 0);
+    assert(a.lower_bound(1000001) == 1);
+    assert(a.lower_bound(1000000 + 2 * 5000) == 5000);
+    assert(a.lower_bound(UINT64_MAX) == a.size());
+    assert(a.contains(1000000 + 2 * 4321));
+    assert(!a.contains(1000000 + 2 * 4321 + 1));
+
+    uint64_t sum = 0;
+    a.for_each([&sum](uint64_t value) { sum += value; });
+    assert(sum == 10000 * 1000000ull + 10000ull * 9999);
+
+    compressed_id_vector b(threes);
+    assert(b.decode() == threes);
+    my_vector<uint64_t> common = intersect(a, b);
+    assert(common.size() == 3334);
+    for (size_t i = 0; i < common.size(); ++i) {
+        assert(a.contains(common[i]) && b.contains(common[i]));
+    }
+
+    try {
+        a.push_back(1);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+        assert(true);
+    }
+}
+
+bool raise_budget_hook(size_t tag, size_t requested_bytes) {
+    memory_budget::set_limit(tag, memory_budget::live_bytes(tag) + requested_bytes);
+    return true;
+}
+
+bool retry_without_room_hook(size_t, size_t) {
+    ++hook_calls;
+    return true;
+}
+
+void test_memory_budget() {
+    constexpr size_t TAG = 5;
+    memory_budget::set_limit(TAG, 1024);
+    {
+        my_vector<int> v(memory_tag{TAG});
+        assert(v.memory_tag_id() == TAG);
+        assert(memory_budget::live_bytes(TAG) == v.capacity() * sizeof(int));
+
+        [[maybe_unused]] bool reserved = v.try_reserve(1000);
+        assert(!reserved);
+        reserved = v.try_reserve(100);
+        assert(reserved);
+
+        size_t pushed = 0;
+        while (v.try_push_back(1)) {
+            ++pushed;
+        }
+        assert(pushed == v.size());
+        assert(memory_budget::live_bytes(TAG) <= 1024);
+
+        try {
+            v.reserve(10000);
+            assert(false);
+        } catch (const memory_budget_exceeded &) {
+            assert(true);
+        }
+
+        memory_budget::set_exceeded_hook(raise_budget_hook);
+        v.reserve(10000);
+        assert(v.capacity() == 10000);
+        memory_budget::set_exceeded_hook(nullptr);
+        assert(memory_budget::peak_bytes(TAG) >= 10000 * sizeof(int));
+
+        my_vector<int> other;
+        other.set_memory_tag(memory_tag{TAG});
+        assert(memory_budget::live_bytes(TAG) == (v.capacity() + other.capacity()) * sizeof(int));
+    }
+    assert(memory_budget::live_bytes(TAG) == 0);
+
+    // Shrinking never fails because of the budget, even when both buffers do not fit under the limit at once
+    memory_budget::set_limit(TAG, 264 * sizeof(int));
+    {
+        my_vector<int> v(memory_tag{TAG});
+        v.set_shrink_threshold(0.25);
+        v.reserve(256);
+        for (int i = 0; i < 256; ++i) {
+            v.push_back(i);
+        }
+        while (!v.is_empty()) {
+            v.pop_back();
+        }
+        assert(v.capacity() < 256);
+        assert(memory_budget::live_bytes(TAG) == v.capacity() * sizeof(int));
+
+        v.reserve(200);
+        v.push_back(1);
+        v.shrink_to_fit();
+        assert(v.capacity() == 1);
+    }
+    assert(memory_budget::live_bytes(TAG) == 0);
+
+    // A hook that asks for a retry without making room gets exactly one retry
+    {
+        my_vector<int> v(memory_tag{TAG});
+        memory_budget::set_limit(TAG, memory_budget::live_bytes(TAG));
+        hook_calls = 0;
+        memory_budget::set_exceeded_hook(retry_without_room_hook);
+        [[maybe_unused]] bool reserved = v.try_reserve(1000);
+        memory_budget::set_exceeded_hook(nullptr);
+        assert(!reserved);
+        assert(hook_calls == 1);
+    }
+    memory_budget::set_limit(TAG, memory_budget::UNLIMITED);
+
+    // A charge the global limit refuses does not raise the tag's peak
+    {
+        my_vector<int> v(memory_tag{3});
+        memory_budget::reset_peak(3);
+        memory_budget::set_global_limit(memory_budget::global_live_bytes() + 64);
+        [[maybe_unused]] bool reserved = v.try_reserve(1'000'000);
+        memory_budget::set_global_limit(memory_budget::UNLIMITED);
+        assert(!reserved);
+        assert(memory_budget::peak_bytes(3) == memory_budget::live_bytes(3));
+    }
+}
+
 int main() {
     test_constructors();
     test_assignment();
@@ -114,6 +555,14 @@ int main() {
     test_modifiers();
     test_insert_erase();
     test_iterators();
+    test_memory_reclaim();
+    test_range_construction();
+    test_const_access();
+    test_bulk_fill_copy();
+    test_numeric_loader();
+    test_slot_map();
+    test_compressed_id_vector();
+    test_memory_budget();
 
     std::cout << "All tests passed successfully.\n";
     return 0;
@@ -0,0 +1,195 @@
+#ifndef BULK_KERNELS_H
+#define BULK_KERNELS_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BULK_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// Bulk fill and copy kernels for trivially copyable element types.
+// Fills broadcast the element into a 32-byte pattern and store it with AVX2 (or SSE2 when AVX2 is not
+// available at runtime). Blocks larger than NON_TEMPORAL_THRESHOLD use streaming stores,
+// so a huge fill or copy does not evict the working set from the cache.
+namespace bulk_kernels {
+    constexpr size_t PATTERN_BYTES = 32;
+    constexpr size_t NON_TEMPORAL_THRESHOLD = 8 * 1024 * 1024;
+
+    // Element types the pattern fill handles: trivially copyable and tiling a 32-byte pattern exactly
+    template<typename T>
+    constexpr bool is_fillable_v = std::is_trivially_copyable_v<T> && PATTERN_BYTES % sizeof(T) == 0;
+
+#ifdef BULK_KERNELS_X86
+    inline bool has_avx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    // pattern holds 64 bytes: the 32-byte pattern twice, so pattern + k is the pattern rotated by k bytes
+    __attribute__((target("avx2")))
+    inline void fill_avx2(unsigned char *dst, size_t bytes, const unsigned char *pattern) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_loadu_si256(
+                                reinterpret_cast<const __m256i *>(pattern)));
+
+        size_t head = (PATTERN_BYTES - reinterpret_cast<uintptr_t>(dst) % PATTERN_BYTES) % PATTERN_BYTES;
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + head));
+        size_t i = head;
+        if (bytes >= NON_TEMPORAL_THRESHOLD) {
+            for (; i + PATTERN_BYTES <= bytes; i += PATTERN_BYTES) {
+                _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), v);
+            }
+            _mm_sfence();
+        } else {
+            for (; i + PATTERN_BYTES <= bytes; i += PATTERN_BYTES) {
+                _mm256_store_si256(reinterpret_cast<__m256i *>(dst + i), v);
+            }
+        }
+
+        size_t tail = bytes - PATTERN_BYTES;
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + tail), _mm256_loadu_si256(
+                                reinterpret_cast<const __m256i *>(pattern + tail % PATTERN_BYTES)));
+    }
+
+    __attribute__((target("sse2")))
+    inline void fill_sse2(unsigned char *dst, size_t bytes, const unsigned char *pattern) {
+        constexpr size_t STEP = 16;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_loadu_si128(
+                             reinterpret_cast<const __m128i *>(pattern)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + STEP), _mm_loadu_si128(
+                             reinterpret_cast<const __m128i *>(pattern + STEP)));
+
+        size_t head = (PATTERN_BYTES - reinterpret_cast<uintptr_t>(dst) % PATTERN_BYTES) % PATTERN_BYTES;
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + head));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + head + STEP));
+        size_t i = head;
+        bool streaming = bytes >= NON_TEMPORAL_THRESHOLD;
+        for (; i + PATTERN_BYTES <= bytes; i += PATTERN_BYTES) {
+            if (streaming) {
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), lo);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + STEP), hi);
+            } else {
+                _mm_store_si128(reinterpret_cast<__m128i *>(dst + i), lo);
+                _mm_store_si128(reinterpret_cast<__m128i *>(dst + i + STEP), hi);
+            }
+        }
+        if (streaming) {
+            _mm_sfence();
+        }
+
+        size_t tail = bytes - PATTERN_BYTES;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + tail), _mm_loadu_si128(
+                             reinterpret_cast<const __m128i *>(pattern + tail % PATTERN_BYTES)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + tail + STEP), _mm_loadu_si128(
+                             reinterpret_cast<const __m128i *>(pattern + tail % PATTERN_BYTES + STEP)));
+    }
+
+    // Streaming copy of a large block: unaligned head, aligned non-temporal body, unaligned tail.
+    // Kept out of line: it only runs for multi-megabyte blocks, and inlined into a copy from a small
+    // array it makes GCC warn about bounds on a branch that is never taken
+    __attribute__((target("avx2"), noinline))
+    inline void stream_copy_avx2(unsigned char *dst, const unsigned char *src, size_t bytes) {
+        size_t head = (PATTERN_BYTES - reinterpret_cast<uintptr_t>(dst) % PATTERN_BYTES) % PATTERN_BYTES;
+        std::memcpy(dst, src, head);
+
+        size_t i = head;
+        for (; i + PATTERN_BYTES <= bytes; i += PATTERN_BYTES) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), v);
+        }
+        _mm_sfence();
+
+        std::memcpy(dst + i, src + i, bytes - i);
+    }
+
+    __attribute__((target("sse2"), noinline))
+    inline void stream_copy_sse2(unsigned char *dst, const unsigned char *src, size_t bytes) {
+        constexpr size_t STEP = 16;
+        size_t head = (STEP - reinterpret_cast<uintptr_t>(dst) % STEP) % STEP;
+        std::memcpy(dst, src, head);
+
+        size_t i = head;
+        for (; i + STEP <= bytes; i += STEP) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), v);
+        }
+        _mm_sfence();
+
+        std::memcpy(dst + i, src + i, bytes - i);
+    }
+#endif
+
+    // Fills bytes of dst with the 32-byte pattern, dst + 0 starting at pattern[0]
+    inline void fill_bytes(unsigned char *dst, size_t bytes, const unsigned char (&pattern)[PATTERN_BYTES]) {
+        if (bytes < PATTERN_BYTES) {
+            std::memcpy(dst, pattern, bytes);
+            return;
+        }
+
+#ifdef BULK_KERNELS_X86
+        unsigned char doubled[2 * PATTERN_BYTES];
+        std::memcpy(doubled, pattern, PATTERN_BYTES);
+        std::memcpy(doubled + PATTERN_BYTES, pattern, PATTERN_BYTES);
+
+        if (has_avx2()) {
+            fill_avx2(dst, bytes, doubled);
+        } else {
+            fill_sse2(dst, bytes, doubled);
+        }
+#else
+        std::memcpy(dst, pattern, PATTERN_BYTES);
+        for (size_t filled = PATTERN_BYTES; filled < bytes;) {
+            size_t chunk = std::min(filled, bytes - filled);
+            std::memcpy(dst + filled, dst, chunk);
+            filled += chunk;
+        }
+#endif
+    }
+
+    // Copies bytes from src to dst; large blocks bypass the cache with streaming stores
+    inline void copy_bytes(void *dst, const void *src, size_t bytes) {
+#ifdef BULK_KERNELS_X86
+        if (bytes >= NON_TEMPORAL_THRESHOLD) {
+            if (has_avx2()) {
+                stream_copy_avx2(static_cast<unsigned char *>(dst), static_cast<const unsigned char *>(src), bytes);
+            } else {
+                stream_copy_sse2(static_cast<unsigned char *>(dst), static_cast<const unsigned char *>(src), bytes);
+            }
+            return;
+        }
+#endif
+        if (bytes != 0) {
+            std::memcpy(dst, src, bytes);
+        }
+    }
+
+    // Constructs count copies of value in uninitialized memory at dst
+    template<typename T>
+    void uninitialized_fill_n(T *dst, size_t count, const T &value) {
+        if constexpr (is_fillable_v<T>) {
+            unsigned char pattern[PATTERN_BYTES];
+            for (size_t i = 0; i < PATTERN_BYTES; i += sizeof(T)) {
+                std::memcpy(pattern + i, std::addressof(value), sizeof(T));
+            }
+            fill_bytes(reinterpret_cast<unsigned char *>(dst), count * sizeof(T), pattern);
+        } else {
+            std::uninitialized_fill_n(dst, count, value);
+        }
+    }
+
+    // Copy-constructs count elements from src in uninitialized memory at dst
+    template<typename T>
+    void uninitialized_copy_n(const T *src, size_t count, T *dst) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            copy_bytes(dst, src, count * sizeof(T));
+        } else {
+            std::uninitialized_copy_n(src, count, dst);
+        }
+    }
+}
+
+#endif //BULK_KERNELS_H
@@ -0,0 +1,178 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+// Byte accounting for every my_vector buffer. Each vector charges its buffer to a tag (0 by default);
+// every tag and the process as a whole have a limit, UNLIMITED by default.
+// An allocation that would exceed a limit calls the exceeded hook, if one is set, and is retried once if the hook
+// asks for it; if it still does not fit, my_vector throws memory_budget_exceeded and the try_* methods return false.
+// Shrinking a buffer is never refused: it ends below the current charge.
+namespace memory_budget {
+    constexpr size_t MAX_TAGS = 64;
+    constexpr size_t UNLIMITED = SIZE_MAX;
+
+    // Called once with the tag and the requested bytes when a limit would be exceeded.
+    // Return true to retry the allocation once (e.g. after freeing caches), false to fail it right away.
+    using exceeded_hook = bool (*)(size_t tag, size_t requested_bytes);
+
+    struct counters {
+        std::atomic<size_t> live{0};
+        std::atomic<size_t> peak{0};
+        std::atomic<size_t> limit{UNLIMITED};
+    };
+
+    inline counters tag_counters[MAX_TAGS];
+    inline counters global_counters;
+    inline std::atomic<exceeded_hook> hook{nullptr};
+
+    inline counters &tag_at(size_t tag) {
+        if (tag >= MAX_TAGS) {
+            throw std::out_of_range("memory budget tag out of range");
+        }
+
+        return tag_counters[tag];
+    }
+
+    // Adds bytes to c.live unless that would go over c.limit; c.peak is left to the caller
+    inline bool try_add_live(counters &c, size_t bytes) {
+        size_t live = c.live.load(std::memory_order_relaxed);
+        size_t updated;
+        do {
+            size_t limit = c.limit.load(std::memory_order_relaxed);
+            if (bytes > limit || live > limit - bytes) {
+                return false;
+            }
+            updated = live + bytes;
+        } while (!c.live.compare_exchange_weak(live, updated, std::memory_order_relaxed));
+
+        return true;
+    }
+
+    // Raises c.peak to the current c.live
+    inline void update_peak(counters &c) {
+        size_t live = c.live.load(std::memory_order_relaxed);
+        size_t peak = c.peak.load(std::memory_order_relaxed);
+        while (peak < live && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Adds bytes to c.live unless that would go over c.limit
+    inline bool try_charge(counters &c, size_t bytes) {
+        if (!try_add_live(c, bytes)) {
+            return false;
+        }
+        update_peak(c);
+
+        return true;
+    }
+
+    // Charges bytes to both the counters and the global budget unless either limit would be exceeded;
+    // the peaks only move once both charges have succeeded
+    inline bool try_charge_both(counters &c, size_t bytes) {
+        if (!try_add_live(c, bytes)) {
+            return false;
+        }
+        if (!try_add_live(global_counters, bytes)) {
+            c.live.fetch_sub(bytes, std::memory_order_relaxed);
+            return false;
+        }
+        update_peak(c);
+        update_peak(global_counters);
+
+        return true;
+    }
+
+    // Charges bytes to the tag and to the global budget; false if either limit would be exceeded
+    // and the exceeded hook did not make room on its single retry
+    inline bool try_acquire(size_t tag, size_t bytes) {
+        counters &c = tag_at(tag);
+        if (try_charge_both(c, bytes)) {
+            return true;
+        }
+
+        exceeded_hook on_exceeded = hook.load();
+        if (on_exceeded == nullptr || !on_exceeded(tag, bytes)) {
+            return false;
+        }
+
+        return try_charge_both(c, bytes);
+    }
+
+    // Charges bytes regardless of the limits; only for shrinking, where the old, larger buffer is released right after
+    inline void charge_unchecked(size_t tag, size_t bytes) {
+        counters &c = tag_at(tag);
+        for (counters *target: {&c, &global_counters}) {
+            target->live.fetch_add(bytes, std::memory_order_relaxed);
+            update_peak(*target);
+        }
+    }
+
+    // Moves bytes already charged to one tag over to another; the global budget is not affected
+    inline bool try_transfer(size_t from_tag, size_t to_tag, size_t bytes) {
+        counters &from = tag_at(from_tag);
+        if (!try_charge(tag_at(to_tag), bytes)) {
+            return false;
+        }
+        from.live.fetch_sub(bytes, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    inline void release(size_t tag, size_t bytes) {
+        tag_at(tag).live.fetch_sub(bytes, std::memory_order_relaxed);
+        global_counters.live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    inline void set_limit(size_t tag, size_t bytes) {
+        tag_at(tag).limit.store(bytes);
+    }
+
+    inline void set_global_limit(size_t bytes) {
+        global_counters.limit.store(bytes);
+    }
+
+    inline void set_exceeded_hook(exceeded_hook on_exceeded) {
+        hook.store(on_exceeded);
+    }
+
+    [[nodiscard]] inline size_t live_bytes(size_t tag) {
+        return tag_at(tag).live.load();
+    }
+
+    [[nodiscard]] inline size_t peak_bytes(size_t tag) {
+        return tag_at(tag).peak.load();
+    }
+
+    [[nodiscard]] inline size_t global_live_bytes() {
+        return global_counters.live.load();
+    }
+
+    [[nodiscard]] inline size_t global_peak_bytes() {
+        return global_counters.peak.load();
+    }
+
+    // Restarts peak tracking of the tag from its current live bytes
+    inline void reset_peak(size_t tag) {
+        counters &c = tag_at(tag);
+        c.peak.store(c.live.load());
+    }
+}
+
+// Tag for constructing a my_vector charged to a memory budget tag: my_vector<T> v(memory_tag{3})
+struct memory_tag {
+    size_t id;
+};
+
+// Thrown by my_vector when an allocation would exceed a memory budget
+class memory_budget_exceeded : public std::bad_alloc {
+public:
+    [[nodiscard]] const char *what() const noexcept override {
+        return "memory budget exceeded";
+    }
+};
+
+#endif //MEMORY_BUDGET_H
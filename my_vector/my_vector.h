@@ -1,7 +1,45 @@
 #ifndef MY_VECTOR_H
 #define MY_VECTOR_H
 #include <memory>
+#include <cassert>
 #include <cmath>
+#include <concepts>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include "bulk_kernels.h"
+#include "memory_budget.h"
+
+// Bounds checking of operator[] (at() always throws):
+// UNCHECKED - no checks, ASSERT - assert() only, HARDENED - traps without throwing.
+// Defaults to UNCHECKED for NDEBUG builds and to ASSERT otherwise.
+// The modes start at 1 so that a misspelled mode, which the preprocessor reads as 0, is rejected below.
+#define MY_VECTOR_CHECKS_UNCHECKED 1
+#define MY_VECTOR_CHECKS_ASSERT 2
+#define MY_VECTOR_CHECKS_HARDENED 3
+
+#ifndef MY_VECTOR_CHECKS
+#ifdef NDEBUG
+#define MY_VECTOR_CHECKS MY_VECTOR_CHECKS_UNCHECKED
+#else
+#define MY_VECTOR_CHECKS MY_VECTOR_CHECKS_ASSERT
+#endif
+#endif
+
+#if MY_VECTOR_CHECKS != MY_VECTOR_CHECKS_UNCHECKED && MY_VECTOR_CHECKS != MY_VECTOR_CHECKS_ASSERT && \
+    MY_VECTOR_CHECKS != MY_VECTOR_CHECKS_HARDENED
+#error "MY_VECTOR_CHECKS must be MY_VECTOR_CHECKS_UNCHECKED, MY_VECTOR_CHECKS_ASSERT or MY_VECTOR_CHECKS_HARDENED"
+#endif
+
+// Tag for the range constructor, mirrors C++23 std::from_range
+struct from_range_t {
+    explicit from_range_t() = default;
+};
+
+inline constexpr from_range_t from_range{};
 
 
 template<typename T>
@@ -13,6 +51,37 @@ private:
     T *data_m;
     size_t size_m;
     size_t capacity_m;
+    // Fraction of capacity below which the vector shrinks itself; 0 disables auto-shrink
+    double shrink_threshold_m = 0.0;
+    // Memory budget tag the buffer is charged to
+    size_t memory_tag_m = 0;
+
+    // Moves the elements into a fresh buffer of exactly new_capacity elements (new_capacity >= size_m),
+    // throws memory_budget_exceeded or std::bad_alloc on failure
+    void reallocate(size_t new_capacity);
+
+    // reallocate() that returns false instead of throwing when the budget or the allocation fails
+    bool try_reallocate(size_t new_capacity);
+
+    // Moves the elements into new_data, frees and uncharges the old buffer
+    void adopt_buffer(T *new_data, size_t new_capacity);
+
+    // Reallocates to a smaller buffer without checking the memory budget (the charge only goes down);
+    // keeps the current buffer if the allocation fails
+    void shrink_to(size_t new_capacity);
+
+    // Shrinks the buffer when the auto-shrink policy is enabled and size dropped below the threshold
+    void maybe_auto_shrink();
+
+    // Checks operator[] indices according to MY_VECTOR_CHECKS
+    void check_index(size_t index) const noexcept;
+
+    // Appends the elements of rg: sized and forward ranges get one exact allocation and a bulk copy
+    // (memcpy for contiguous ranges of trivially copyable T), single-pass ranges grow geometrically.
+    // Forward ranges that are not sized (list iterator pairs, forward_list) are walked twice, once to count:
+    // a second pointer walk is cheaper than the reallocations and element moves of geometric growth
+    template<class R>
+    void append_range(R &&rg);
 
     class my_iterator {
     private:
@@ -21,6 +90,7 @@ private:
     public:
         // used as reference: https://stackoverflow.com/questions/12092448/code-for-a-basic-random-access-iterator-based-on-pointers
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
         using difference_type = std::ptrdiff_t;
         using value_type = T;
         using pointer = T *;
@@ -61,13 +131,13 @@ private:
             return *this;
         }
 
-        my_iterator operator++(int) const {
+        my_iterator operator++(int) {
             my_iterator tmp(*this);
             ++ptr_m;
             return tmp;
         }
 
-        my_iterator operator--(int) const {
+        my_iterator operator--(int) {
             my_iterator tmp(*this);
             --ptr_m;
             return tmp;
@@ -106,6 +176,9 @@ public:
     // Default constructor
     my_vector();
 
+    // Empty vector charged to a memory budget tag
+    explicit my_vector(memory_tag tag);
+
     // Constructor for a vector of a certain size
     my_vector(size_t size);
 
@@ -113,9 +186,14 @@ public:
     my_vector(size_t size, const T &value);
 
     // Constructor that copies an interval set with Iterators
-    template<class InputIt>
+    template<std::input_iterator InputIt>
     my_vector(InputIt first, InputIt last);
 
+    // Constructor from a range: my_vector<T> v(from_range, rg)
+    template<std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    my_vector(from_range_t, R &&rg);
+
     // Constructor from inizialization list
     my_vector(std::initializer_list<T> init);
 
@@ -137,7 +215,7 @@ public:
     // Assign
     void assign(size_t count, const T &value);
 
-    template<class InputIt>
+    template<std::input_iterator InputIt>
     void assign(InputIt first, InputIt last);
 
     void assign(std::initializer_list<T> ilist);
@@ -166,11 +244,11 @@ public:
     // Begin / End
     iterator begin() { return iterator(data_m); }
     // const_iterator begin() const { return const_iterator(data_m[0]); }
-    const_iterator cbegin() const noexcept { return const_iterator(&data_m[0]); }
+    const_iterator cbegin() const noexcept { return const_iterator(data_m); }
 
-    iterator end() { return iterator(&data_m[size_m]); }
+    iterator end() { return iterator(data_m + size_m); }
     // const_iterator end() const { return iterator(data_m[size_m]); }
-    const_iterator cend() const noexcept { return iterator(&data_m[size_m]); }
+    const_iterator cend() const noexcept { return iterator(data_m + size_m); }
 
     // Reverse iterators
     reverse_iterator rbegin() { return reverse_iterator(end()); }
@@ -181,14 +259,14 @@ public:
     const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
     const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
-    // Index query with no checks operator[]
+    // Index query operator[], checked only as configured by MY_VECTOR_CHECKS
     T &operator[](size_t index);
 
+    const T &operator[](size_t index) const;
+
     // Method at() that throws exceptions
     const T &at(size_t index) const;
 
-    T &operator[](size_t index) const;
-
     // resize()
     void resize(size_t new_size);
 
@@ -197,21 +275,43 @@ public:
     // reserve()
     void reserve(size_t new_capacity);
 
+    // try_reserve() - returns false instead of throwing if the memory budget or the allocation fails
+    bool try_reserve(size_t new_capacity);
+
+    // Memory budget tag the buffer is charged to; changing it moves the charge to the new tag
+    // and throws memory_budget_exceeded if the new tag's limit does not allow it
+    [[nodiscard]] size_t memory_tag_id() const;
+
+    void set_memory_tag(memory_tag tag);
+
     // capacity()
     [[nodiscard]] size_t capacity() const;
 
     // size()
     [[nodiscard]] size_t size() const;
 
-    // shrink_to_fit()
+    // shrink_to_fit() - reallocates to exactly size() elements
     void shrink_to_fit();
 
+    // Enables auto-shrink: when size() falls below fraction * capacity() after an erase, pop_back() or resize(),
+    // the buffer is reallocated to SIZE_MULT * size(). The fraction must be in [0, 1 / SIZE_MULT),
+    // so a shrink never leaves the vector right at the threshold again; 0 disables the policy.
+    void set_shrink_threshold(double fraction);
+
+    [[nodiscard]] double shrink_threshold() const;
+
+    // Bytes held by the vector itself: the object plus its allocated buffer (not memory owned by the elements)
+    [[nodiscard]] size_t memory_footprint() const;
+
     // swap()
     void swap(my_vector &other) noexcept;
 
-    // clear()
+    // clear() - destroys the elements, keeps the capacity
     void clear();
 
+    // clear_and_release() - destroys the elements and frees the buffer
+    void clear_and_release();
+
     // Two types of insert() - the first one takes Iterator where to insert and a value,
     // the second takes iterator where to insert and a pair of iterators from where to take.
     // Returns an iterator to the first inserted element
@@ -223,7 +323,7 @@ public:
     //                 const T &value);
 
     // Iterator pointing to the first element inserted, or pos if no element is inserted.
-
+    // Contiguous ranges of T are copied in bulk (memcpy for trivially copyable T).
     template<class InputIt>
     iterator insert(const_iterator pos, InputIt first, InputIt last);
 
@@ -243,6 +343,11 @@ public:
 
     void push_back(T &&value);
 
+    // try_push_back() - returns false instead of throwing if growing fails
+    bool try_push_back(const T &value);
+
+    bool try_push_back(T &&value);
+
     // emplace_back()
     template<class... Args>
     reference emplace_back(Args &&... args);
@@ -258,35 +363,55 @@ my_vector<T>::my_vector() : data_m{nullptr}, size_m{0}, capacity_m{0} {
 }
 
 template<typename T>
-my_vector<T>::my_vector(const size_t size) : data_m{nullptr}, size_m{size}, capacity_m{size} {
-    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size));
+my_vector<T>::my_vector(memory_tag tag) : data_m{nullptr}, size_m{0}, capacity_m{0}, memory_tag_m{tag.id} {
+    reserve(SIZE_MULT * MIN_VECTOR_LEN);
 }
 
 template<typename T>
-my_vector<T>::my_vector(const size_t size, const T &value) : data_m{nullptr}, size_m{size}, capacity_m{0} {
+my_vector<T>::my_vector(const size_t size) : data_m{nullptr}, size_m{0}, capacity_m{0} {
     reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size));
+    size_m = size;
+}
 
-    for (size_t i = 0; i < size; i++) {
-        data_m[i] = value;
+template<typename T>
+my_vector<T>::my_vector(const size_t size, const T &value) : data_m{nullptr}, size_m{0}, capacity_m{0} {
+    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size));
+    try {
+        bulk_kernels::uninitialized_fill_n(data_m, size, value);
+    } catch (...) {
+        clear_and_release();
+        throw;
     }
+    size_m = size;
 }
 
 template<typename T>
-template<class InputIt>
-my_vector<T>::my_vector(InputIt first, InputIt last) : size_m(0), capacity_m(0), data_m(nullptr) {
-    size_m = std::distance(first, last);
-    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m));
-    // capacity_m = size_m;
+template<std::input_iterator InputIt>
+my_vector<T>::my_vector(InputIt first, InputIt last) : data_m(nullptr), size_m(0), capacity_m(0) {
+    try {
+        append_range(std::ranges::subrange(std::move(first), std::move(last)));
+    } catch (...) {
+        clear_and_release();
+        throw;
+    }
+}
 
-    for (size_t i = 0; first != last; ++first) {
-        new(&data_m[i]) T{*first};
-        ++i;
+template<typename T>
+template<std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+my_vector<T>::my_vector(from_range_t, R &&rg) : data_m(nullptr), size_m(0), capacity_m(0) {
+    try {
+        append_range(std::forward<R>(rg));
+    } catch (...) {
+        clear_and_release();
+        throw;
     }
 }
 
 template<typename T>
-my_vector<T>::my_vector(std::initializer_list<T> init) : data_m(nullptr), size_m(init.size()), capacity_m(init.size()) {
-    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m));
+my_vector<T>::my_vector(std::initializer_list<T> init) : data_m(nullptr), size_m(0), capacity_m(0) {
+    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, init.size()));
+    size_m = init.size();
 
     auto it = init.begin();
     for (size_t i = 0; i < init.size(); ++i, ++it) {
@@ -295,34 +420,35 @@ my_vector<T>::my_vector(std::initializer_list<T> init) : data_m(nullptr), size_m
 }
 
 template<typename T>
-my_vector<T>::my_vector(const my_vector<T> &other) : capacity_m(0), size_m(0), data_m(nullptr) {
-
-    if (capacity_m < other.size_m) {
-        reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, other.size_m));
+my_vector<T>::my_vector(const my_vector<T> &other) : data_m(nullptr), size_m(0), capacity_m(0),
+                                                      memory_tag_m(other.memory_tag_m) {
+    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, other.size_m));
+
+    try {
+        bulk_kernels::uninitialized_copy_n(other.data_m, other.size_m, data_m);
+    } catch (...) {
+        clear_and_release();
+        throw;
     }
     size_m = other.size_m;
-
-    for (size_t i = 0; i < size_m; i++) {
-        data_m[i] = other.data_m[i];
-    }
 }
 
 template<typename T>
 my_vector<T>::my_vector(my_vector<T> &&other) noexcept {
-    data_m = std::move(other.data_m);
+    data_m = other.data_m;
     size_m = other.size_m;
     capacity_m = other.capacity_m;
+    shrink_threshold_m = other.shrink_threshold_m;
+    memory_tag_m = other.memory_tag_m;
 
-    // other.data_m = nullptr;
-    // other.size_m = 0;
-    // other.capacity_m = 0;
+    other.data_m = nullptr;
+    other.size_m = 0;
+    other.capacity_m = 0;
 }
 
 template<typename T>
 my_vector<T>::~my_vector() {
-    clear();
-
-    ::operator delete(data_m);
+    clear_and_release();
 }
 
 template<typename T>
@@ -337,38 +463,27 @@ size_t my_vector<T>::size() {
 
 template<typename T>
 void my_vector<T>::assign(size_t count, const T &value) {
-    if (size_m < count) {
-        size_m = count;
-        reserve(SIZE_MULT * size_m);
+    clear();
+    if (capacity_m < count) {
+        reserve(SIZE_MULT * count);
     }
 
+    bulk_kernels::uninitialized_fill_n(data_m, count, value);
     size_m = count;
-
-    for (size_t i = 0; i < size_m; i++) {
-        data_m[i] = value;
-    }
 }
 
 template<typename T>
-template<class InputIt>
+template<std::input_iterator InputIt>
 void my_vector<T>::assign(InputIt first, InputIt last) {
-    if (std::distance(first, last) > size_m) {
-        size_m = std::distance(first, last);
-        reserve(SIZE_MULT * size_m);
-    }
-
-    size_t i = 0;
-    for (InputIt it = first; it != last; ++it) {
-        data_m[i++] = *it;
-    }
+    clear();
+    append_range(std::ranges::subrange(std::move(first), std::move(last)));
 }
 
 template<typename T>
 void my_vector<T>::assign(std::initializer_list<T> ilist) {
+    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, ilist.size()));
     size_m = ilist.size();
 
-    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m));
-
     auto it = ilist.begin();
     for (size_t i = 0; i < size_m; ++i, ++it) {
         data_m[i] = *it;
@@ -391,6 +506,7 @@ typename my_vector<T>::iterator my_vector<T>::erase(const_iterator pos) {
     }
 
     --size_m;
+    maybe_auto_shrink();
 
     return iterator(data_m + index);
 }
@@ -412,12 +528,15 @@ typename my_vector<T>::iterator my_vector<T>::erase(const_iterator first, const_
     }
 
     size_m -= (end - start);
+    maybe_auto_shrink();
+
     return iterator(data_m + start);
 }
 
 template<typename T>
 void my_vector<T>::pop_back() {
-    size_m--;
+    std::destroy_at(&data_m[--size_m]);
+    maybe_auto_shrink();
 }
 
 template<typename T>
@@ -438,6 +557,26 @@ void my_vector<T>::push_back(T &&value) {
     data_m[size_m++] = std::forward<T>(value);
 }
 
+template<typename T>
+bool my_vector<T>::try_push_back(const T &value) {
+    if (size_m >= capacity_m && !try_reallocate(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m))) {
+        return false;
+    }
+
+    new(&data_m[size_m++]) T(value);
+    return true;
+}
+
+template<typename T>
+bool my_vector<T>::try_push_back(T &&value) {
+    if (size_m >= capacity_m && !try_reallocate(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m))) {
+        return false;
+    }
+
+    new(&data_m[size_m++]) T(std::move(value));
+    return true;
+}
+
 template<typename T>
 template<class... Args>
 typename my_vector<T>::reference my_vector<T>::emplace_back(Args &&... args) {
@@ -475,11 +614,13 @@ typename my_vector<T>::reference my_vector<T>::emplace_back(Args &&... args) {
 
 template<typename T>
 my_vector<T> &my_vector<T>::operator=(const my_vector &other) {
-    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m));
+    if (this == &other) return *this;
+
+    clear();
+    reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, other.size_m));
+
+    bulk_kernels::uninitialized_copy_n(other.data_m, other.size_m, data_m);
     size_m = other.size_m;
-    for (size_t i = 0; i < size_m; i++) {
-        data_m[i] = other.data_m[i];
-    }
 
     return *this;
 }
@@ -494,13 +635,17 @@ template<typename T>
 my_vector<T> &my_vector<T>::operator=(my_vector &&other) noexcept {
     if (this == &other) return *this;
 
-    clear();
+    clear_and_release();
 
     data_m = other.data_m;
     size_m = other.size_m;
     capacity_m = other.capacity_m;
+    shrink_threshold_m = other.shrink_threshold_m;
+    memory_tag_m = other.memory_tag_m;
 
-    other.clear();
+    other.data_m = nullptr;
+    other.size_m = 0;
+    other.capacity_m = 0;
 
     return *this;
 }
@@ -525,8 +670,25 @@ typename my_vector<T>::const_reference my_vector<T>::back() const {
     return data_m[size_m - 1];
 }
 
+template<typename T>
+void my_vector<T>::check_index([[maybe_unused]] size_t index) const noexcept {
+#if MY_VECTOR_CHECKS == MY_VECTOR_CHECKS_ASSERT
+    assert(index < size_m && "index out of range");
+#elif MY_VECTOR_CHECKS == MY_VECTOR_CHECKS_HARDENED
+    if (index >= size_m) [[unlikely]] {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_trap();
+#else
+        std::abort();
+#endif
+    }
+#endif
+}
+
 template<typename T>
 T &my_vector<T>::operator[](size_t index) {
+    check_index(index);
+
     return data_m[index];
 }
 
@@ -540,10 +702,8 @@ const T &my_vector<T>::at(size_t index) const {
 }
 
 template<typename T>
-T &my_vector<T>::operator[](size_t index) const {
-    if (index >= size_m) {
-        throw std::out_of_range("index out of range");
-    }
+const T &my_vector<T>::operator[](size_t index) const {
+    check_index(index);
 
     return data_m[index];
 }
@@ -553,6 +713,8 @@ void my_vector<T>::swap(my_vector &other) noexcept {
     std::swap(size_m, other.size_m);
     std::swap(capacity_m, other.capacity_m);
     std::swap(data_m, other.data_m);
+    std::swap(shrink_threshold_m, other.shrink_threshold_m);
+    std::swap(memory_tag_m, other.memory_tag_m);
 }
 
 template<typename T>
@@ -561,39 +723,183 @@ void my_vector<T>::clear() {
         std::destroy_at(&data_m[i]);
     }
 
-    data_m = nullptr;
     size_m = 0;
+}
+
+template<typename T>
+void my_vector<T>::clear_and_release() {
+    clear();
+
+    ::operator delete(data_m);
+    memory_budget::release(memory_tag_m, capacity_m * sizeof(T));
+    data_m = nullptr;
     capacity_m = 0;
 }
 
 template<typename T>
 void my_vector<T>::resize(size_t new_size) {
     if (size_m > new_size) {
+        for (size_t i = new_size; i < size_m; i++) {
+            std::destroy_at(&data_m[i]);
+        }
         size_m = new_size;
+        maybe_auto_shrink();
     } else {
+        if (capacity_m < new_size) {
+            reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, new_size));
+        }
         size_m = new_size;
-        reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m));
     }
 }
 
 template<typename T>
 void my_vector<T>::reserve(size_t new_capacity) {
-    if (capacity_m > new_capacity) {
+    if (capacity_m >= new_capacity) {
         return;
     }
 
-    capacity_m = new_capacity;
-    T * new_data_m = static_cast<T *>(::operator new(capacity_m * sizeof(T)));
+    reallocate(new_capacity);
+}
 
-    if (data_m != nullptr) {
-        for (size_t i = 0; i < size_m; ++i) {
-            new(&new_data_m[i]) T(data_m[i]);
-            std::destroy_at(&data_m[i]);
+template<typename T>
+bool my_vector<T>::try_reserve(size_t new_capacity) {
+    if (capacity_m >= new_capacity) {
+        return true;
+    }
+
+    return try_reallocate(new_capacity);
+}
+
+template<typename T>
+void my_vector<T>::reallocate(size_t new_capacity) {
+    if (new_capacity > SIZE_MAX / sizeof(T)) {
+        throw std::length_error("my_vector capacity too large");
+    }
+
+    size_t new_bytes = new_capacity * sizeof(T);
+    if (!memory_budget::try_acquire(memory_tag_m, new_bytes)) {
+        throw memory_budget_exceeded();
+    }
+
+    T *new_data_m = nullptr;
+    if (new_capacity != 0) {
+        try {
+            new_data_m = static_cast<T *>(::operator new(new_bytes));
+        } catch (...) {
+            memory_budget::release(memory_tag_m, new_bytes);
+            throw;
         }
     }
 
+    adopt_buffer(new_data_m, new_capacity);
+}
+
+template<typename T>
+bool my_vector<T>::try_reallocate(size_t new_capacity) {
+    if (new_capacity > SIZE_MAX / sizeof(T)) {
+        return false;
+    }
+
+    size_t new_bytes = new_capacity * sizeof(T);
+    if (!memory_budget::try_acquire(memory_tag_m, new_bytes)) {
+        return false;
+    }
+
+    T *new_data_m = nullptr;
+    if (new_capacity != 0) {
+        new_data_m = static_cast<T *>(::operator new(new_bytes, std::nothrow));
+        if (new_data_m == nullptr) {
+            memory_budget::release(memory_tag_m, new_bytes);
+            return false;
+        }
+    }
+
+    adopt_buffer(new_data_m, new_capacity);
+    return true;
+}
+
+template<typename T>
+void my_vector<T>::adopt_buffer(T *new_data, size_t new_capacity) {
+    for (size_t i = 0; i < size_m; ++i) {
+        new(&new_data[i]) T(std::move_if_noexcept(data_m[i]));
+        std::destroy_at(&data_m[i]);
+    }
+
     ::operator delete(data_m);
-    data_m = new_data_m;
+    memory_budget::release(memory_tag_m, capacity_m * sizeof(T));
+    data_m = new_data;
+    capacity_m = new_capacity;
+}
+
+template<typename T>
+size_t my_vector<T>::memory_tag_id() const {
+    return memory_tag_m;
+}
+
+template<typename T>
+void my_vector<T>::set_memory_tag(memory_tag tag) {
+    if (!memory_budget::try_transfer(memory_tag_m, tag.id, capacity_m * sizeof(T))) {
+        throw memory_budget_exceeded();
+    }
+
+    memory_tag_m = tag.id;
+}
+
+template<typename T>
+template<class R>
+void my_vector<T>::append_range(R &&rg) {
+    if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+        size_t count = static_cast<size_t>(std::ranges::distance(rg));
+        if (count == 0) {
+            return;
+        }
+        if (capacity_m < size_m + count) {
+            reserve(size_m + count);
+        }
+
+        using range_value_t = std::ranges::range_value_t<R>;
+        if constexpr (std::ranges::contiguous_range<R> && std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::remove_cv_t<range_value_t>, T>) {
+            bulk_kernels::copy_bytes(data_m + size_m, std::ranges::data(rg), count * sizeof(T));
+        } else {
+            std::uninitialized_copy_n(std::ranges::begin(rg), count, data_m + size_m);
+        }
+        size_m += count;
+    } else {
+        for (auto it = std::ranges::begin(rg); it != std::ranges::end(rg); ++it) {
+            emplace_back(*it);
+        }
+    }
+}
+
+template<typename T>
+void my_vector<T>::maybe_auto_shrink() {
+    if (shrink_threshold_m == 0.0) {
+        return;
+    }
+
+    size_t target = SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m);
+    if (target >= capacity_m) {
+        return;
+    }
+
+    if (static_cast<double>(size_m) < shrink_threshold_m * static_cast<double>(capacity_m)) {
+        shrink_to(target);
+    }
+}
+
+template<typename T>
+void my_vector<T>::shrink_to(size_t new_capacity) {
+    T *new_data_m = nullptr;
+    if (new_capacity != 0) {
+        new_data_m = static_cast<T *>(::operator new(new_capacity * sizeof(T), std::nothrow));
+        if (new_data_m == nullptr) {
+            return;
+        }
+    }
+
+    memory_budget::charge_unchecked(memory_tag_m, new_capacity * sizeof(T));
+    adopt_buffer(new_data_m, new_capacity);
 }
 
 template<typename T>
@@ -608,20 +914,45 @@ size_t my_vector<T>::size() const {
 
 template<typename T>
 void my_vector<T>::shrink_to_fit() {
-    reserve(SIZE_MULT * size_m);
+    if (capacity_m != size_m) {
+        shrink_to(size_m);
+    }
+}
+
+template<typename T>
+void my_vector<T>::set_shrink_threshold(double fraction) {
+    if (!(fraction >= 0.0 && fraction < 1.0 / SIZE_MULT)) {
+        throw std::invalid_argument("shrink threshold must be in [0, 1 / SIZE_MULT)");
+    }
+
+    shrink_threshold_m = fraction;
+    maybe_auto_shrink();
+}
+
+template<typename T>
+double my_vector<T>::shrink_threshold() const {
+    return shrink_threshold_m;
+}
+
+template<typename T>
+size_t my_vector<T>::memory_footprint() const {
+    return sizeof(*this) + capacity_m * sizeof(T);
 }
 
 template<typename T>
 void my_vector<T>::resize(size_t new_size, const T &new_element) {
     if (size_m > new_size) {
+        for (size_t i = new_size; i < size_m; i++) {
+            std::destroy_at(&data_m[i]);
+        }
         size_m = new_size;
+        maybe_auto_shrink();
     } else {
-        size_t begin = size_m;
-        size_m = new_size;
-        reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, size_m));
-        for (size_t i = begin; i < size_m; i++) {
-            data_m[i] = new_element;
+        if (capacity_m < new_size) {
+            reserve(SIZE_MULT * std::max(MIN_VECTOR_LEN, new_size));
         }
+        bulk_kernels::uninitialized_fill_n(data_m + size_m, new_size - size_m, new_element);
+        size_m = new_size;
     }
 }
 
@@ -635,7 +966,7 @@ typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, InputIt
         return iterator(data_m + index);
     }
 
-    if (size_m + count >= capacity_m) {
+    if (size_m + count > capacity_m) {
         reserve(std::max(capacity_m * SIZE_MULT, size_m + count));
     }
 
@@ -644,9 +975,14 @@ typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, InputIt
         data_m[i - 1].~T();
     }
 
-    size_t insert_i = index;
-    for (; first != last; ++first, ++insert_i) {
-        new(&data_m[insert_i]) T(*first);
+    if constexpr (std::contiguous_iterator<InputIt> &&
+                  std::is_same_v<std::remove_cv_t<std::iter_value_t<InputIt>>, T>) {
+        bulk_kernels::uninitialized_copy_n(std::to_address(first), count, data_m + index);
+    } else {
+        size_t insert_i = index;
+        for (; first != last; ++first, ++insert_i) {
+            new(&data_m[insert_i]) T(*first);
+        }
     }
 
     size_m += count;
@@ -0,0 +1,113 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "numeric_loader.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NUMERIC_LOADER_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+numeric_parse_error::numeric_parse_error(const std::string &what, size_t line, size_t column)
+    : std::runtime_error(what + " at line " + std::to_string(line) + ", column " + std::to_string(column)),
+      line_m(line), column_m(column) {
+}
+
+size_t numeric_parse_error::line() const {
+    return line_m;
+}
+
+size_t numeric_parse_error::column() const {
+    return column_m;
+}
+
+mapped_file::mapped_file(const std::string &path) {
+#ifdef NUMERIC_LOADER_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("cannot open file: " + path);
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) == -1) {
+        ::close(fd);
+        throw std::runtime_error("cannot stat file: " + path);
+    }
+
+    size_m = static_cast<size_t>(info.st_size);
+    if (size_m != 0) {
+        void *mapping = ::mmap(nullptr, size_m, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("cannot map file: " + path);
+        }
+        ::madvise(mapping, size_m, MADV_SEQUENTIAL);
+        data_m = static_cast<const char *>(mapping);
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open file: " + path);
+    }
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    buffer_m = contents.str();
+    data_m = buffer_m.data();
+    size_m = buffer_m.size();
+#endif
+}
+
+mapped_file::~mapped_file() {
+#ifdef NUMERIC_LOADER_MMAP
+    if (data_m != nullptr) {
+        ::munmap(const_cast<char *>(data_m), size_m);
+    }
+#endif
+}
+
+std::string_view mapped_file::text() const {
+    return {data_m, size_m};
+}
+
+namespace numeric_loader_detail {
+    std::vector<std::string_view> split_chunks(std::string_view text, size_t chunks_count) {
+        chunks_count = std::max<size_t>(1, chunks_count);
+
+        std::vector<std::string_view> chunks;
+        chunks.reserve(chunks_count);
+
+        size_t begin = 0;
+        for (size_t i = 1; i <= chunks_count; ++i) {
+            size_t end = text.size();
+            if (i != chunks_count) {
+                end = std::max(begin, text.size() / chunks_count * i);
+                while (end < text.size() && !is_separator(text[end])) {
+                    ++end;
+                }
+            }
+
+            chunks.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+
+        return chunks;
+    }
+
+    void throw_parse_error(std::string_view text, size_t offset, const std::string &what) {
+        std::string_view before = text.substr(0, offset);
+
+        size_t line = static_cast<size_t>(std::count(before.begin(), before.end(), '\n')) + 1;
+        size_t line_start = before.rfind('\n');
+        size_t column = line_start == std::string_view::npos ? offset + 1 : offset - line_start;
+
+        throw numeric_parse_error(what, line, column);
+    }
+}
@@ -0,0 +1,183 @@
+#ifndef NUMERIC_LOADER_H
+#define NUMERIC_LOADER_H
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "my_vector.h"
+
+// Thrown when a numeric file cannot be parsed; line and column are 1-based
+class numeric_parse_error : public std::runtime_error {
+private:
+    size_t line_m;
+    size_t column_m;
+
+public:
+    numeric_parse_error(const std::string &what, size_t line, size_t column);
+
+    [[nodiscard]] size_t line() const;
+
+    [[nodiscard]] size_t column() const;
+};
+
+// Read-only view of a whole file: memory-mapped on POSIX systems, read into a buffer elsewhere
+class mapped_file {
+private:
+    const char *data_m = nullptr;
+    size_t size_m = 0;
+    std::string buffer_m;
+
+public:
+    explicit mapped_file(const std::string &path);
+
+    mapped_file(const mapped_file &) = delete;
+
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    ~mapped_file();
+
+    [[nodiscard]] std::string_view text() const;
+};
+
+namespace numeric_loader_detail {
+    // Files smaller than this per thread are not worth splitting further
+    constexpr size_t MIN_CHUNK_BYTES = 1024 * 1024;
+
+    constexpr bool is_separator(char c) {
+        return c == ',' || c == '\n' || c == '\r' || c == ' ' || c == '\t';
+    }
+
+    // Splits text into up to chunks_count pieces, each ending at a separator boundary
+    std::vector<std::string_view> split_chunks(std::string_view text, size_t chunks_count);
+
+    // Throws numeric_parse_error for the given offset, translated to line and column of text
+    [[noreturn]] void throw_parse_error(std::string_view text, size_t offset, const std::string &what);
+
+    template<typename T>
+    struct chunk_result {
+        my_vector<T> values;
+        size_t error_offset = std::string_view::npos;
+        std::errc error = std::errc{};
+        // Exception thrown while parsing (e.g. std::bad_alloc or memory_budget_exceeded), rethrown by the caller
+        std::exception_ptr exception;
+    };
+
+    // Parses one chunk; stops at the first malformed field and records its offset within the chunk
+    template<typename T>
+    void parse_chunk(std::string_view chunk, chunk_result<T> &result) {
+        const char *begin = chunk.data();
+        const char *end = begin + chunk.size();
+        const char *p = begin;
+
+        while (p != end) {
+            if (is_separator(*p)) {
+                ++p;
+                continue;
+            }
+
+            T value;
+            auto [next, ec] = std::from_chars(p, end, value);
+            if (ec == std::errc{} && next != end && !is_separator(*next)) {
+                ec = std::errc::invalid_argument;
+            }
+            if (ec != std::errc{}) {
+                result.error_offset = static_cast<size_t>(p - begin);
+                result.error = ec;
+                return;
+            }
+
+            result.values.push_back(value);
+            p = next;
+        }
+    }
+
+    // parse_chunk() for worker threads: exceptions are stored in the result instead of terminating
+    template<typename T>
+    void parse_chunk_captured(std::string_view chunk, chunk_result<T> &result) noexcept {
+        try {
+            parse_chunk(chunk, result);
+        } catch (...) {
+            result.exception = std::current_exception();
+        }
+    }
+}
+
+// Parses comma-, whitespace- or newline-separated numbers. The text is split at separator boundaries and
+// the chunks are parsed in parallel with std::from_chars, then concatenated with one exact-size allocation.
+// threads == 0 picks the thread count from the hardware and the text size.
+template<typename T>
+my_vector<T> parse_numeric_text(std::string_view text, size_t threads = 0) {
+    using namespace numeric_loader_detail;
+
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        threads = std::max<size_t>(1, std::min(threads, text.size() / MIN_CHUNK_BYTES));
+    }
+
+    std::vector<std::string_view> chunks = split_chunks(text, threads);
+    std::vector<chunk_result<T>> results(chunks.size());
+
+    if (chunks.size() == 1) {
+        parse_chunk(chunks[0], results[0]);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(chunks.size());
+        try {
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                workers.emplace_back(parse_chunk_captured<T>, chunks[i], std::ref(results[i]));
+            }
+        } catch (...) {
+            for (auto &worker: workers) {
+                worker.join();
+            }
+            throw;
+        }
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    for (auto &result: results) {
+        if (result.exception) {
+            std::rethrow_exception(result.exception);
+        }
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (results[i].error != std::errc{}) {
+            size_t offset = static_cast<size_t>(chunks[i].data() - text.data()) + results[i].error_offset;
+            throw_parse_error(text, offset, results[i].error == std::errc::result_out_of_range
+                                                ? "number out of range"
+                                                : "invalid number");
+        }
+        total += results[i].values.size();
+    }
+
+    // Built from an empty range the vector has no buffer yet, so reserve(total) is its only allocation
+    my_vector<T> values(from_range, std::views::empty<T>);
+    values.reserve(total);
+    for (auto &result: results) {
+        values.insert(values.end(), result.values.begin(), result.values.end());
+    }
+
+    return values;
+}
+
+// Loads a numeric file into a my_vector, see parse_numeric_text()
+template<typename T>
+my_vector<T> load_numeric_file(const std::string &path, size_t threads = 0) {
+    mapped_file file(path);
+
+    return parse_numeric_text<T>(file.text(), threads);
+}
+
+#endif //NUMERIC_LOADER_H
@@ -0,0 +1,246 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "my_vector.h"
+
+// Container with stable generational handles on top of my_vector.
+// Values are stored densely (iteration is a plain my_vector walk, in no particular order), and a slot table
+// maps every handle to its value's current position. Insert, erase (swapping in the last value) and lookup
+// are O(1); erasing bumps the slot's generation, so handles to erased values are detected as stale.
+template<typename T>
+class slot_map {
+public:
+    struct handle {
+        uint32_t index;
+        uint32_t generation;
+
+        bool operator==(const handle &rhs) const = default;
+    };
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    // For a live slot dense_index is the value's position, for a free one -- the next free slot
+    struct slot {
+        uint32_t dense_index;
+        uint32_t generation;
+    };
+
+    my_vector<T> values_m;
+    my_vector<uint32_t> dense_to_slot_m;
+    my_vector<slot> slots_m;
+    uint32_t free_head_m = NO_SLOT;
+
+    // Returns the dense index for a live handle or NO_SLOT for a stale one
+    [[nodiscard]] uint32_t dense_index(handle h) const;
+
+    // Takes a slot from the free list (or a new one) and points it at the last value;
+    // if growing the tables throws, they are left unchanged
+    handle bind_last_value();
+
+public:
+    using iterator = typename my_vector<T>::iterator;
+    using const_iterator = typename my_vector<T>::const_iterator;
+
+    slot_map() = default;
+
+    // insert()
+    handle insert(const T &value);
+
+    handle insert(T &&value);
+
+    // emplace()
+    template<class... Args>
+    handle emplace(Args &&... args);
+
+    // erase() - returns false if the handle is stale
+    bool erase(handle h);
+
+    // contains()
+    [[nodiscard]] bool contains(handle h) const;
+
+    // find() - returns nullptr if the handle is stale
+    T *find(handle h);
+
+    const T *find(handle h) const;
+
+    // at() that throws exceptions for stale handles
+    T &at(handle h);
+
+    const T &at(handle h) const;
+
+    // size(), is_empty()
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool is_empty() const;
+
+    // reserve()
+    void reserve(size_t new_capacity);
+
+    // clear() - invalidates every handle
+    void clear();
+
+    // Dense iteration over the values
+    iterator begin() { return values_m.begin(); }
+    iterator end() { return values_m.end(); }
+    const_iterator cbegin() const noexcept { return values_m.cbegin(); }
+    const_iterator cend() const noexcept { return values_m.cend(); }
+};
+
+
+template<typename T>
+uint32_t slot_map<T>::dense_index(handle h) const {
+    if (h.index >= slots_m.size()) {
+        return NO_SLOT;
+    }
+
+    const slot &s = slots_m[h.index];
+    if (s.generation != h.generation || s.dense_index >= values_m.size() ||
+        dense_to_slot_m[s.dense_index] != h.index) {
+        return NO_SLOT;
+    }
+
+    return s.dense_index;
+}
+
+template<typename T>
+typename slot_map<T>::handle slot_map<T>::bind_last_value() {
+    uint32_t dense = static_cast<uint32_t>(values_m.size() - 1);
+    uint32_t index = free_head_m != NO_SLOT ? free_head_m : static_cast<uint32_t>(slots_m.size());
+
+    dense_to_slot_m.push_back(index);
+
+    if (free_head_m != NO_SLOT) {
+        free_head_m = slots_m[index].dense_index;
+        slots_m[index].dense_index = dense;
+    } else {
+        try {
+            slots_m.push_back(slot{dense, 0});
+        } catch (...) {
+            dense_to_slot_m.pop_back();
+            throw;
+        }
+    }
+
+    return handle{index, slots_m[index].generation};
+}
+
+template<typename T>
+typename slot_map<T>::handle slot_map<T>::insert(const T &value) {
+    return emplace(value);
+}
+
+template<typename T>
+typename slot_map<T>::handle slot_map<T>::insert(T &&value) {
+    return emplace(std::move(value));
+}
+
+template<typename T>
+template<class... Args>
+typename slot_map<T>::handle slot_map<T>::emplace(Args &&... args) {
+    values_m.emplace_back(std::forward<Args>(args)...);
+
+    try {
+        return bind_last_value();
+    } catch (...) {
+        values_m.pop_back();
+        throw;
+    }
+}
+
+template<typename T>
+bool slot_map<T>::erase(handle h) {
+    uint32_t dense = dense_index(h);
+    if (dense == NO_SLOT) {
+        return false;
+    }
+
+    uint32_t last = static_cast<uint32_t>(values_m.size() - 1);
+    if (dense != last) {
+        values_m[dense] = std::move(values_m[last]);
+        dense_to_slot_m[dense] = dense_to_slot_m[last];
+        slots_m[dense_to_slot_m[dense]].dense_index = dense;
+    }
+    values_m.pop_back();
+    dense_to_slot_m.pop_back();
+
+    slot &s = slots_m[h.index];
+    ++s.generation;
+    s.dense_index = free_head_m;
+    free_head_m = h.index;
+
+    return true;
+}
+
+template<typename T>
+bool slot_map<T>::contains(handle h) const {
+    return dense_index(h) != NO_SLOT;
+}
+
+template<typename T>
+T *slot_map<T>::find(handle h) {
+    uint32_t dense = dense_index(h);
+
+    return dense == NO_SLOT ? nullptr : &values_m[dense];
+}
+
+template<typename T>
+const T *slot_map<T>::find(handle h) const {
+    uint32_t dense = dense_index(h);
+
+    return dense == NO_SLOT ? nullptr : &values_m[dense];
+}
+
+template<typename T>
+T &slot_map<T>::at(handle h) {
+    T *value = find(h);
+    if (value == nullptr) {
+        throw std::out_of_range("stale slot_map handle");
+    }
+
+    return *value;
+}
+
+template<typename T>
+const T &slot_map<T>::at(handle h) const {
+    const T *value = find(h);
+    if (value == nullptr) {
+        throw std::out_of_range("stale slot_map handle");
+    }
+
+    return *value;
+}
+
+template<typename T>
+size_t slot_map<T>::size() const {
+    return values_m.size();
+}
+
+template<typename T>
+bool slot_map<T>::is_empty() const {
+    return values_m.is_empty();
+}
+
+template<typename T>
+void slot_map<T>::reserve(size_t new_capacity) {
+    values_m.reserve(new_capacity);
+    dense_to_slot_m.reserve(new_capacity);
+    slots_m.reserve(new_capacity);
+}
+
+template<typename T>
+void slot_map<T>::clear() {
+    for (size_t i = 0; i < dense_to_slot_m.size(); ++i) {
+        slot &s = slots_m[dense_to_slot_m[i]];
+        ++s.generation;
+        s.dense_index = free_head_m;
+        free_head_m = dense_to_slot_m[i];
+    }
+
+    values_m.clear();
+    dense_to_slot_m.clear();
+}
+
+#endif //SLOT_MAP_H